@@ -0,0 +1,161 @@
+#include "BusStatistics.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+	// Indexed like BusStatistics feeders; read from Bus/PowerSource so renames carry over
+	const std::string& feederName(int feeder)
+	{
+		static const std::string names[] = {
+			Bus(BusName::AC1).getPoweredBy(), // label of an unpowered bus
+			PowerSource(SourceType::External).name(),
+			PowerSource(SourceType::APUGen).name(),
+			PowerSource(SourceType::Eng1Gen).name(),
+			PowerSource(SourceType::Eng2Gen).name(),
+			PowerSource(SourceType::Battery).name()
+		};
+		return names[feeder];
+	}
+}
+
+BusStatistics::BusStatistics()
+	: aircraft(0),
+	feederSeconds{},
+	powerTransitions{},
+	changeovers{},
+	standbyLosses(0),
+	runActive(false),
+	lastFeeder{},
+	secondsOnBattery(0.0),
+	runMinCharge(0.0)
+{
+}
+
+int BusStatistics::feederIndex(const Bus& bus)
+{
+	if (!bus.isPowered()) return 0;
+
+	const std::string source = bus.getPoweredBy();
+	for (int f = 1; f < feederCount; ++f)
+		if (source == feederName(f)) return f;
+	return 0;
+}
+
+void BusStatistics::observe(const ElectricalSystem& elec, double deltaSeconds)
+{
+	if (!runActive)
+	{
+		runActive = true;
+		std::fill(std::begin(lastFeeder), std::end(lastFeeder), -1);
+		secondsOnBattery = 0.0;
+		runMinCharge = elec.getBatteryCharge();
+	}
+
+	const Bus* buses[busCount] = { &elec.getAC1(), &elec.getAC2(), &elec.getDC1(), &elec.getDC2(), &elec.getStandby() };
+
+	for (int b = 0; b < busCount; ++b)
+	{
+		int feeder = feederIndex(*buses[b]);
+		int previous = lastFeeder[b];
+
+		if (previous >= 0 && previous != feeder)
+		{
+			if ((previous == 0) != (feeder == 0)) ++powerTransitions[b];
+			else ++changeovers[b];
+		}
+
+		// STANDBY dropping off an empty battery (not a BAT switch-off);
+		// the tick that drained it was still spent on the battery
+		if (b == standbyIndex)
+		{
+			if (previous == batteryFeeder && feeder == 0 && elec.getBatteryCharge() <= 0.0)
+			{
+				++standbyLosses;
+				standbyLossTime.add(secondsOnBattery + deltaSeconds);
+			}
+			secondsOnBattery = (feeder == batteryFeeder) ? secondsOnBattery + deltaSeconds : 0.0;
+		}
+
+		feederSeconds[b][feeder] += deltaSeconds;
+		lastFeeder[b] = feeder;
+	}
+
+	runMinCharge = std::min(runMinCharge, elec.getBatteryCharge());
+}
+
+void BusStatistics::endAircraft()
+{
+	if (!runActive) return;
+
+	++aircraft;
+	batteryMinimum.add(runMinCharge);
+	runActive = false;
+}
+
+void BusStatistics::merge(const BusStatistics& other)
+{
+	aircraft += other.aircraft;
+	for (int b = 0; b < busCount; ++b)
+	{
+		for (int f = 0; f < feederCount; ++f)
+			feederSeconds[b][f] += other.feederSeconds[b][f];
+		powerTransitions[b] += other.powerTransitions[b];
+		changeovers[b] += other.changeovers[b];
+	}
+	standbyLosses += other.standbyLosses;
+	standbyLossTime.merge(other.standbyLossTime);
+	batteryMinimum.merge(other.batteryMinimum);
+}
+
+double BusStatistics::getPoweredSeconds(BusName bus) const
+{
+	int b = static_cast<int>(bus);
+	double seconds = 0.0;
+	for (int f = 1; f < feederCount; ++f)
+		seconds += feederSeconds[b][f];
+	return seconds;
+}
+
+void BusStatistics::printSummary() const
+{
+	std::cout << "Aircraft runs : " << aircraft << "\n\n";
+
+	std::cout << std::left << std::setw(10) << "BUS" << std::right << std::setw(8) << "PWR %";
+	for (int f = 1; f < feederCount; ++f) std::cout << std::setw(10) << feederName(f);
+	std::cout << std::setw(10) << "ON/OFF" << std::setw(10) << "XFER" << "\n";
+
+	std::streamsize oldPrecision = std::cout.precision();
+	std::cout << std::fixed << std::setprecision(1);
+	for (int b = 0; b < busCount; ++b)
+	{
+		double total = 0.0;
+		for (int f = 0; f < feederCount; ++f) total += feederSeconds[b][f];
+		double powered = getPoweredSeconds(static_cast<BusName>(b));
+
+		std::cout << std::left << std::setw(10) << Bus(static_cast<BusName>(b)).getName()
+			<< std::right << std::setw(8) << (total > 0.0 ? 100.0 * powered / total : 0.0);
+		for (int f = 1; f < feederCount; ++f)
+			std::cout << std::setw(10) << (total > 0.0 ? 100.0 * feederSeconds[b][f] / total : 0.0);
+		std::cout << std::setw(10) << powerTransitions[b] << std::setw(10) << changeovers[b] << "\n";
+	}
+
+	std::cout << "\nSTANDBY lost on battery : " << standbyLosses << " times";
+	if (standbyLossTime.size() > 0)
+	{
+		std::cout << " (after p50 " << standbyLossTime.quantile(0.5)
+			<< " s, p90 " << standbyLossTime.quantile(0.9)
+			<< " s, p99 " << standbyLossTime.quantile(0.99) << " s)";
+	}
+	std::cout << "\n";
+
+	if (batteryMinimum.size() > 0)
+	{
+		std::cout << "Battery minimum charge  : lowest " << batteryMinimum.min()
+			<< "%, p10 " << batteryMinimum.quantile(0.1)
+			<< "%, p50 " << batteryMinimum.quantile(0.5) << "%\n";
+	}
+	std::cout << std::defaultfloat;
+	std::cout.precision(oldPrecision);
+}
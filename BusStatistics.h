@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "ElectricalSystem.h"
+#include "QuantileSketch.h"
+
+// Online bus-availability aggregate for batch runs. Memory is fixed no matter
+// how long or how many aircraft are fed; one instance per thread, merge() at the end.
+class BusStatistics
+{
+private:
+	static constexpr int busCount = 5;    // AC1, AC2, DC1, DC2, STANDBY
+	static constexpr int feederCount = 6; // None, EXT PWR, APU GEN, ENG1 GEN, ENG2 GEN, BATTERY
+	static constexpr int standbyIndex = 4;
+	static constexpr int batteryFeeder = 5;
+
+	// --- Aggregate (mergeable) ---
+	uint64_t aircraft;
+	double feederSeconds[busCount][feederCount]; // time spent fed by each source (None = unpowered)
+	uint64_t powerTransitions[busCount];         // ON <-> OFF
+	uint64_t changeovers[busCount];              // powered, but feeder switched
+	uint64_t standbyLosses;
+	QuantileSketch standbyLossTime;              // seconds on battery before STANDBY dropped
+	QuantileSketch batteryMinimum;               // lowest charge per aircraft
+
+	// --- Current aircraft ---
+	bool runActive;
+	int lastFeeder[busCount];
+	double secondsOnBattery;
+	double runMinCharge;
+
+	static int feederIndex(const Bus& bus);
+
+public:
+	// Constructor
+	BusStatistics();
+
+	// Feed one state: the system sat in this state for deltaSeconds
+	void observe(const ElectricalSystem& elec, double deltaSeconds);
+	void endAircraft(); // close the current aircraft's run
+
+	// Combine a finished partial (call endAircraft() on both first)
+	void merge(const BusStatistics& other);
+
+	// Monitoring
+	double getPoweredSeconds(BusName bus) const;
+	void printSummary() const;
+};
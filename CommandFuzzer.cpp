@@ -0,0 +1,298 @@
+#include "CommandFuzzer.h"
+#include <cstring>
+
+namespace
+{
+	// Feeder names exactly as recalculate() writes them, so a renamed source carries over
+	const std::string names[] = {
+		Bus(BusName::AC1).getPoweredBy(), // label of an unpowered bus
+		PowerSource(SourceType::External).name(),
+		PowerSource(SourceType::APUGen).name(),
+		PowerSource(SourceType::Eng1Gen).name(),
+		PowerSource(SourceType::Eng2Gen).name(),
+		PowerSource(SourceType::Battery).name()
+	};
+
+	const char* const none = names[0].c_str();
+	const char* const ext = names[1].c_str();
+	const char* const apu = names[2].c_str();
+	const char* const eng1 = names[3].c_str();
+	const char* const eng2 = names[4].c_str();
+	const char* const bat = names[5].c_str();
+
+	bool fedBy(const Bus& bus, const char* source)
+	{
+		return bus.getPoweredBy() == source;
+	}
+
+	// Source/breaker bits -> feeders. Built from the priority rules, independently
+	// of recalculate(), so the two can be compared.
+	struct BusTable
+	{
+		CommandFuzzer::Feeds rows[256];
+
+		BusTable()
+		{
+			for (int key = 0; key < 256; ++key)
+			{
+				bool idg1 = key & 1, idg2 = key & 2, apuOn = key & 4, extOn = key & 8;
+				bool btb1 = key & 16, btb2 = key & 32, batOn = key & 64, batCharged = key & 128;
+
+				bool anyIDG = idg1 || idg2;
+				const char* shared = anyIDG ? none : apuOn ? apu : extOn ? ext : none;
+
+				// Own sources first, then cross-feed through whichever BTB is closed
+				const char* ac1 = idg1 ? eng1 : shared;
+				const char* ac2 = idg2 ? eng2 : shared != none ? shared : (btb2 ? ac1 : none);
+				if (ac1 == none && btb1) ac1 = ac2;
+				const char* standby = ac1 != none ? ac1 : (batOn && batCharged) ? bat : none;
+
+				rows[key] = { ac1, ac2, ac1, ac2, standby };
+			}
+		}
+	};
+}
+
+CommandFuzzer::CommandFuzzer(uint64_t seed, size_t maxSequence)
+	: rngState(seed ? seed : 0x9E3779B97F4A7C15ull),
+	stepsRun(0),
+	sequencesRun(0),
+	standbyLosses(0),
+	maxSequenceLength(maxSequence < 16 ? 16 : maxSequence)
+{
+	// Grows only as deep as sequences actually get, not to the configured maximum
+	trace.reserve(maxSequenceLength < 4096 ? maxSequenceLength : 4096);
+}
+
+void CommandFuzzer::addEngine(const std::string& name, Engine feeds)
+{
+	engines.push_back({ name, std::move(feeds) });
+}
+
+void CommandFuzzer::addDefaultEngines()
+{
+	addEngine("table-driven", &CommandFuzzer::tableFeeds);
+}
+
+uint64_t CommandFuzzer::nextRandom()
+{
+	// xorshift64*: cheap enough to stay out of the profile
+	rngState ^= rngState >> 12;
+	rngState ^= rngState << 25;
+	rngState ^= rngState >> 27;
+	return rngState * 0x2545F4914F6CDD1Dull;
+}
+
+size_t CommandFuzzer::randomSequenceLength()
+{
+	int maxExponent = 4;
+	while ((size_t(2) << maxExponent) <= maxSequenceLength) ++maxExponent;
+
+	// Pick a power-of-two band uniformly, then a length inside it
+	uint64_t r = nextRandom();
+	int exponent = 4 + static_cast<int>(r % static_cast<uint64_t>(maxExponent - 3));
+	size_t band = size_t(1) << exponent;
+	size_t length = band + static_cast<size_t>((r >> 8) % band);
+	return length < maxSequenceLength ? length : maxSequenceLength;
+}
+
+CommandFuzzer::Step CommandFuzzer::randomStep(bool draining)
+{
+	uint64_t r = nextRandom();
+	Step step{};
+
+	// A quarter of steps advance time so startups and battery drain get exercised;
+	// draining sequences tick almost every step so the battery can run flat
+	bool tick = draining ? (r & 15) != 0 : (r & 3) == 0;
+	step.op = tick ? Op::Tick : static_cast<Op>((r >> 4) % static_cast<uint64_t>(Op::Tick));
+	step.available = ((r >> 16) & 7) != 0; // mostly keep sources available
+	step.online = (r >> 19) & 1;
+	step.seconds = static_cast<double>(((r >> 20) % 100) + 1) * 0.1; // 0.1 .. 10 s
+	return step;
+}
+
+void CommandFuzzer::apply(const Step& step)
+{
+	switch (step.op)
+	{
+		case Op::ToggleExt: elec.toggleExtPower(); break;
+		case Op::ToggleAPU: elec.toggleAPUGen(); break;
+		case Op::ToggleEng1: elec.toggleEng1Gen(); break;
+		case Op::ToggleEng2: elec.toggleEng2Gen(); break;
+		case Op::ToggleBattery: elec.toggleBattery(); break;
+		case Op::StartAPU: elec.startAPU(); break;
+		case Op::StartEng1: elec.startEng1(); break;
+		case Op::StartEng2: elec.startEng2(); break;
+		case Op::SetExt: elec.setExtPower(step.available, step.online); break;
+		case Op::SetAPU: elec.setAPUGen(step.available, step.online); break;
+		case Op::SetEng1: elec.setEng1Gen(step.available, step.online); break;
+		case Op::SetEng2: elec.setEng2Gen(step.available, step.online); break;
+		case Op::SetBattery: elec.setBattery(step.available, step.online); break;
+		case Op::ToggleBTB1: elec.toggleBTB1(); break;
+		case Op::ToggleBTB2: elec.toggleBTB2(); break;
+		case Op::Tick: elec.tickSources(step.seconds); break;
+	}
+	elec.recalculate();
+}
+
+const char* CommandFuzzer::checkEngines() const
+{
+	const Bus* buses[5] = { &elec.getAC1(), &elec.getAC2(), &elec.getDC1(), &elec.getDC2(), &elec.getStandby() };
+
+	for (const auto& engine : engines)
+	{
+		Feeds expected = engine.feeds(elec);
+		for (int b = 0; b < 5; ++b)
+		{
+			bool powered = std::strcmp(expected[b], none) != 0;
+			if (buses[b]->isPowered() != powered || !fedBy(*buses[b], expected[b]))
+				return engine.name.c_str();
+		}
+	}
+	return nullptr;
+}
+
+const char* CommandFuzzer::checkInvariants() const
+{
+	const Bus& ac1 = elec.getAC1();
+	const Bus& ac2 = elec.getAC2();
+	const Bus& dc1 = elec.getDC1();
+	const Bus& dc2 = elec.getDC2();
+	const Bus& standby = elec.getStandby();
+
+	// DC buses follow their TRU's AC bus
+	if (dc1.isPowered() != ac1.isPowered() || dc1.getPoweredBy() != ac1.getPoweredBy())
+		return "DC BUS 1 does not match AC BUS 1";
+	if (dc2.isPowered() != ac2.isPowered() || dc2.getPoweredBy() != ac2.getPoweredBy())
+		return "DC BUS 2 does not match AC BUS 2";
+
+	// A closed BTB ties a dead AC bus to a live one
+	if (!ac1.isPowered() && elec.getBTB1Closed() && ac2.isPowered())
+		return "AC BUS 1 unpowered while BTB1 closed and AC BUS 2 powered";
+	if (!ac2.isPowered() && elec.getBTB2Closed() && ac1.isPowered())
+		return "AC BUS 2 unpowered while BTB2 closed and AC BUS 1 powered";
+
+	// Standby: AC1 first, battery as fallback
+	if (ac1.isPowered())
+	{
+		if (!standby.isPowered() || standby.getPoweredBy() != ac1.getPoweredBy())
+			return "STANDBY not fed from powered AC BUS 1";
+	}
+	else
+	{
+		if (standby.isPowered() && !fedBy(standby, bat))
+			return "STANDBY fed by non-battery source without AC BUS 1";
+		if (fedBy(standby, bat) && elec.getBatteryCharge() <= 0.0)
+			return "STANDBY fed by an empty battery";
+		if (!standby.isPowered() && elec.getBatteryOnline() && elec.getBatteryCharge() > 0.0)
+			return "STANDBY lost with charged battery online";
+	}
+
+	double charge = elec.getBatteryCharge();
+	if (charge < 0.0 || charge > 100.0)
+		return "battery charge out of 0-100%";
+
+	// Nothing stays online (or comes online) while unavailable
+	for (const PowerSource* src : { &elec.getExtPwr(), &elec.getAPUGen(), &elec.getEng1Gen(), &elec.getEng2Gen(), &elec.getBattery() })
+		if (src->isOnline() && !src->isAvailable())
+			return "source online while unavailable";
+
+	// Generators come online only once spooled up
+	if ((elec.isAPUStarting() && elec.getAPUGenOnline()) ||
+		(elec.isEng1Starting() && elec.getEng1GenOnline()) ||
+		(elec.isEng2Starting() && elec.getEng2GenOnline()))
+		return "generator online while still starting";
+
+	return nullptr;
+}
+
+bool CommandFuzzer::run(uint64_t steps, Failure& failure)
+{
+	const ElectricalSystem fresh;
+
+	for (uint64_t done = 0; done < steps; ++sequencesRun)
+	{
+		elec = fresh;
+		elec.recalculate();
+		trace.clear();
+
+		size_t length = randomSequenceLength();
+		bool draining = (nextRandom() & 3) == 0;
+
+		for (size_t i = 0; i < length && done < steps; ++i, ++done)
+		{
+			// Draining sequences open with the battery online and then mostly tick
+			Step step = (draining && i == 0) ? Step{ Op::SetBattery, true, true, 0.0 } : randomStep(draining);
+			trace.push_back(step);
+
+			apply(step);
+			const char* engine = checkEngines();
+			const char* broken = nullptr;
+
+			// Battery runs after the bus recalc, as in the ConsoleUI loop
+			if (!engine)
+			{
+				if (step.op == Op::Tick)
+				{
+					bool onBattery = fedBy(elec.getStandby(), bat);
+					elec.updateBattery(step.seconds);
+					if (onBattery && !elec.getStandby().isPowered()) ++standbyLosses;
+				}
+				broken = checkInvariants();
+			}
+
+			++stepsRun;
+			if (engine || broken)
+			{
+				failure.check = engine ? std::string(engine) + " engine disagrees with recalculate()" : broken;
+				failure.sequence = sequencesRun;
+				failure.trace = trace;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+std::string CommandFuzzer::stepName(const Step& step)
+{
+	auto set = [&](const char* what) {
+		return std::string(what) + "(" + (step.available ? "avail" : "unavail") + ", " + (step.online ? "on" : "off") + ")";
+	};
+
+	switch (step.op)
+	{
+		case Op::ToggleExt: return "toggleExtPower";
+		case Op::ToggleAPU: return "toggleAPUGen";
+		case Op::ToggleEng1: return "toggleEng1Gen";
+		case Op::ToggleEng2: return "toggleEng2Gen";
+		case Op::ToggleBattery: return "toggleBattery";
+		case Op::StartAPU: return "startAPU";
+		case Op::StartEng1: return "startEng1";
+		case Op::StartEng2: return "startEng2";
+		case Op::SetExt: return set("setExtPower");
+		case Op::SetAPU: return set("setAPUGen");
+		case Op::SetEng1: return set("setEng1Gen");
+		case Op::SetEng2: return set("setEng2Gen");
+		case Op::SetBattery: return set("setBattery");
+		case Op::ToggleBTB1: return "toggleBTB1";
+		case Op::ToggleBTB2: return "toggleBTB2";
+		case Op::Tick: return "tick(" + std::to_string(step.seconds) + " s)";
+	}
+	return "UNKNOWN";
+}
+
+CommandFuzzer::Feeds CommandFuzzer::tableFeeds(const ElectricalSystem& elec)
+{
+	static const BusTable table;
+
+	int key = (elec.getEng1GenOnline() ? 1 : 0)
+		| (elec.getEng2GenOnline() ? 2 : 0)
+		| (elec.getAPUGenOnline() ? 4 : 0)
+		| (elec.getExtPowerOnline() ? 8 : 0)
+		| (elec.getBTB1Closed() ? 16 : 0)
+		| (elec.getBTB2Closed() ? 32 : 0)
+		| (elec.getBatteryOnline() ? 64 : 0)
+		| (elec.getBatteryCharge() > 0.0 ? 128 : 0);
+	return table.rows[key];
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "ElectricalSystem.h"
+
+// Random interleavings of the ElectricalSystem control API, checked after every step.
+// Each sequence starts from a fresh system; lengths are log-uniform from 16 steps up
+// to the configured maximum, so most traces stay short while some run deep.
+class CommandFuzzer
+{
+public:
+	enum class Op : uint8_t
+	{
+		ToggleExt, ToggleAPU, ToggleEng1, ToggleEng2, ToggleBattery,
+		StartAPU, StartEng1, StartEng2,
+		SetExt, SetAPU, SetEng1, SetEng2, SetBattery,
+		ToggleBTB1, ToggleBTB2,
+		Tick
+	};
+
+	struct Step
+	{
+		Op op;
+		bool available;  // Set* only
+		bool online;     // Set* only
+		double seconds;  // Tick only
+	};
+
+	struct Failure
+	{
+		std::string check;
+		uint64_t sequence = 0;   // index of the failing sequence
+		std::vector<Step> trace; // steps from a fresh system, last one fails
+	};
+
+	// Feeder name per bus (AC1, AC2, DC1, DC2, STANDBY), "None" if unpowered
+	using Feeds = std::array<const char*, 5>;
+	using Engine = std::function<Feeds(const ElectricalSystem&)>;
+
+private:
+	struct NamedEngine
+	{
+		std::string name;
+		Engine feeds;
+	};
+
+	uint64_t rngState;
+	uint64_t stepsRun;
+	uint64_t sequencesRun;
+	uint64_t standbyLosses; // coverage: STANDBY dropped off an empty battery
+	size_t maxSequenceLength;
+	ElectricalSystem elec;
+	std::vector<NamedEngine> engines;
+
+	std::vector<Step> trace; // current sequence, reused between sequences
+
+	uint64_t nextRandom();
+	size_t randomSequenceLength();
+	Step randomStep(bool draining);
+	void apply(const Step& step);
+	const char* checkEngines() const;
+	const char* checkInvariants() const;
+
+public:
+	// Constructor (maxSequence: longest sequence before a reset, at least 16)
+	CommandFuzzer(uint64_t seed, size_t maxSequence = 4096);
+
+	// Differential engines (compared against recalculate() after every step)
+	void addEngine(const std::string& name, Engine feeds);
+	void addDefaultEngines();
+
+	// Fuzzing (true = every check held; otherwise failure is filled in)
+	bool run(uint64_t steps, Failure& failure);
+	uint64_t getStepsRun() const { return stepsRun; }
+	uint64_t getStandbyLosses() const { return standbyLosses; }
+
+	static std::string stepName(const Step& step);
+	static Feeds tableFeeds(const ElectricalSystem& elec); // table-driven bus engine
+};
@@ -1,4 +1,5 @@
 ﻿#include "ConsoleUI.h"
+#include "PanelAction.h"
 #include <chrono>
 #include <conio.h>
 #include <iostream>
@@ -106,9 +107,7 @@ void ConsoleUI::showMenu()
     while (running)
     {
         // Progress sources + battery each second
-        elec.tickSources(1.0);     // ⬅️ NEW: advance startup timers
-        elec.recalculate();
-        elec.updateBattery(1.0);
+        tickPanel(elec, 1.0);
 
         // Draw updated panel
         drawPanel();
@@ -132,55 +131,40 @@ void ConsoleUI::showMenu()
             int key = _getch();
             switch (key) {
                 case '1':
-                    elec.toggleExtPower();
+                    applyPanelAction(elec, PanelAction::ExtPower);
                     pushLog(std::string("EXT PWR -> ") + (elec.getExtPowerOnline() ? "ON" : "OFF"));
                     break;
 
                 case '2':
-                    if (!elec.getAPUGenOnline() && !elec.isAPUStarting()) {
-                        elec.startAPU();    // wrapper → apuGen.beginStartup(5s)
-                        pushLog("APU starting...");
-                    }
-                    else if (elec.getAPUGenOnline()) {
-                        elec.toggleAPUGen();
-                        pushLog("APU GEN OFF");
-                    }
+                    if (elec.getAPUGenOnline()) pushLog("APU GEN OFF");
+                    else if (!elec.isAPUStarting()) pushLog("APU starting...");
+                    applyPanelAction(elec, PanelAction::APUGen);
                     break;
 
                 case '3':
-                    if (!elec.getEng1GenOnline() && !elec.isEng1Starting()) {
-                        elec.startEng1();   // wrapper → eng1Gen.beginStartup(7s)
-                        pushLog("ENG1 spooling up...");
-                    }
-                    else if (elec.getEng1GenOnline()) {
-                        elec.toggleEng1Gen();
-                        pushLog("ENG1 GEN OFF");
-                    }
+                    if (elec.getEng1GenOnline()) pushLog("ENG1 GEN OFF");
+                    else if (!elec.isEng1Starting()) pushLog("ENG1 spooling up...");
+                    applyPanelAction(elec, PanelAction::Eng1Gen);
                     break;
 
                 case '4':
-                    if (!elec.getEng2GenOnline() && !elec.isEng2Starting()) {
-                        elec.startEng2();   // wrapper → eng2Gen.beginStartup(7s)
-                        pushLog("ENG2 spooling up...");
-                    }
-                    else if (elec.getEng2GenOnline()) {
-                        elec.toggleEng2Gen();
-                        pushLog("ENG2 GEN OFF");
-                    }
+                    if (elec.getEng2GenOnline()) pushLog("ENG2 GEN OFF");
+                    else if (!elec.isEng2Starting()) pushLog("ENG2 spooling up...");
+                    applyPanelAction(elec, PanelAction::Eng2Gen);
                     break;
 
                 case '5':
-                    elec.toggleBattery();
+                    applyPanelAction(elec, PanelAction::Battery);
                     pushLog(std::string("BATTERY -> ") + (elec.getBatteryOnline() ? "ON" : "OFF"));
                     break;
 
                 case '6':
-                    elec.toggleBTB1();
+                    applyPanelAction(elec, PanelAction::BTB1);
                     pushLog(std::string("BTB1 -> ") + (elec.getBTB1Closed() ? "CLOSED" : "OPEN"));
                     break;
 
                 case '7':
-                    elec.toggleBTB2();
+                    applyPanelAction(elec, PanelAction::BTB2);
                     pushLog(std::string("BTB2 -> ") + (elec.getBTB2Closed() ? "CLOSED" : "OPEN"));
                     break;
 
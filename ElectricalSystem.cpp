@@ -69,6 +69,10 @@ void ElectricalSystem::updateBattery(double deltaSeconds)
         standby.setPowered(false, "");
         emit("BATTERY DISCHARGED - STANDBY LOST");
     }
+    else if (!standby.isPowered() && battery.isOnline() && battery.getCharge() > 0.0) {
+        // recalculate() ran on an empty battery; it has just picked up charge
+        standby.setPowered(true, battery.name());
+    }
 }
 
 void ElectricalSystem::tickSources(double deltaSeconds)
@@ -112,9 +116,6 @@ void ElectricalSystem::recalculate()
     else if (allowExt) {
         ac1.setPowered(true, extPwr.name());
     }
-    else if (btb1.isClosed() && ac2.isPowered()) {
-        ac1.setPowered(true, ac2.getPoweredBy());
-    }
 
     // --- AC Bus 2 ---
     if (idg2On) {
@@ -130,6 +131,11 @@ void ElectricalSystem::recalculate()
         ac2.setPowered(true, ac1.getPoweredBy());
     }
 
+    // --- AC Bus 1 cross-feed (only once AC2 is resolved) ---
+    if (!ac1.isPowered() && btb1.isClosed() && ac2.isPowered()) {
+        ac1.setPowered(true, ac2.getPoweredBy());
+    }
+
     // --- DC Buses (fed from AC via TRUs) ---
     dc1.setPowered(ac1.isPowered(), ac1.getPoweredBy());
     dc2.setPowered(ac2.isPowered(), ac2.getPoweredBy());
@@ -138,7 +144,7 @@ void ElectricalSystem::recalculate()
     if (ac1.isPowered()) {
         standby.setPowered(true, ac1.getPoweredBy());
     }
-    else if (battery.isOnline()) {
+    else if (battery.isOnline() && battery.getCharge() > 0.0) {
         standby.setPowered(true, battery.name());
     }
     else {
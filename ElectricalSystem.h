@@ -89,4 +89,11 @@ public:
     const Bus& getDC1() const { return dc1; }
     const Bus& getDC2() const { return dc2; }
     const Bus& getStandby() const { return standby; }
+
+    // --- Source accessors ---
+    const PowerSource& getExtPwr() const { return extPwr; }
+    const PowerSource& getAPUGen() const { return apuGen; }
+    const PowerSource& getEng1Gen() const { return eng1Gen; }
+    const PowerSource& getEng2Gen() const { return eng2Gen; }
+    const PowerSource& getBattery() const { return battery; }
 };
@@ -0,0 +1,65 @@
+#include "PanelAction.h"
+
+void applyPanelAction(ElectricalSystem& elec, PanelAction action)
+{
+	switch (action)
+	{
+		case PanelAction::Wait:
+			break;
+
+		case PanelAction::ExtPower:
+			elec.toggleExtPower();
+			break;
+
+		// Generators: start when idle, switch off when online, ignore while spooling
+		case PanelAction::APUGen:
+			if (!elec.getAPUGenOnline() && !elec.isAPUStarting()) elec.startAPU();
+			else if (elec.getAPUGenOnline()) elec.toggleAPUGen();
+			break;
+
+		case PanelAction::Eng1Gen:
+			if (!elec.getEng1GenOnline() && !elec.isEng1Starting()) elec.startEng1();
+			else if (elec.getEng1GenOnline()) elec.toggleEng1Gen();
+			break;
+
+		case PanelAction::Eng2Gen:
+			if (!elec.getEng2GenOnline() && !elec.isEng2Starting()) elec.startEng2();
+			else if (elec.getEng2GenOnline()) elec.toggleEng2Gen();
+			break;
+
+		case PanelAction::Battery:
+			elec.toggleBattery();
+			break;
+
+		case PanelAction::BTB1:
+			elec.toggleBTB1();
+			break;
+
+		case PanelAction::BTB2:
+			elec.toggleBTB2();
+			break;
+	}
+}
+
+void tickPanel(ElectricalSystem& elec, double deltaSeconds)
+{
+	elec.tickSources(deltaSeconds);
+	elec.recalculate();
+	elec.updateBattery(deltaSeconds);
+}
+
+std::string panelActionName(PanelAction action)
+{
+	switch (action)
+	{
+		case PanelAction::Wait: return "WAIT";
+		case PanelAction::ExtPower: return "EXT PWR";
+		case PanelAction::APUGen: return "APU GEN";
+		case PanelAction::Eng1Gen: return "ENG1 GEN";
+		case PanelAction::Eng2Gen: return "ENG2 GEN";
+		case PanelAction::Battery: return "BATTERY";
+		case PanelAction::BTB1: return "BTB1";
+		case PanelAction::BTB2: return "BTB2";
+	}
+	return "UNKNOWN";
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "ElectricalSystem.h"
+
+// Menu actions offered by ConsoleUI, so tools can drive the panel without a keyboard
+enum class PanelAction : uint8_t { Wait, ExtPower, APUGen, Eng1Gen, Eng2Gen, Battery, BTB1, BTB2 };
+
+constexpr int panelActionCount = 8;
+
+// Same effect as pressing the matching menu key (Wait = no key pressed)
+void applyPanelAction(ElectricalSystem& elec, PanelAction action);
+
+// One pass of the ConsoleUI loop: sources, buses, then battery
+void tickPanel(ElectricalSystem& elec, double deltaSeconds);
+
+std::string panelActionName(PanelAction action);
@@ -13,7 +13,14 @@ PowerSource::PowerSource(SourceType t)
 {
 }
 
-void PowerSource::setAvailable(bool a) { available = a; }
+void PowerSource::setAvailable(bool a) {
+	available = a;
+	if (!available) {
+		// losing the source drops it offline and aborts any spool-up
+		online = false;
+		starting = false;
+	}
+}
 void PowerSource::setOnline(bool o) {
 	if (o) {
 		// only allow ON if available and not starting
@@ -70,7 +77,7 @@ void PowerSource::tickBattery(bool discharging, bool recharging, double deltaSec
 
 void PowerSource::beginStartup(double duration)
 {
-	if (!online && !starting)
+	if (available && !online && !starting)
 	{
 		starting = true;
 		startupTime = duration;
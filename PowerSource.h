@@ -40,4 +40,5 @@ public:
 	void beginStartup(double duration);
 	void tickStartup(double deltaSeconds);
 	bool isStarting() const { return starting; }
+	double getStartupElapsed() const { return elapsedStartup; }
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+QuantileSketch::QuantileSketch()
+	: buckets{},
+	count(0),
+	minSeen(std::numeric_limits<double>::infinity()),
+	maxSeen(-std::numeric_limits<double>::infinity())
+{
+}
+
+double QuantileSketch::gamma()
+{
+	return (1.0 + relativeAccuracy) / (1.0 - relativeAccuracy);
+}
+
+int QuantileSketch::bucketFor(double value)
+{
+	static const double logGamma = std::log(gamma());
+
+	if (value <= minValue) return 0;
+	int index = static_cast<int>(std::ceil(std::log(value / minValue) / logGamma));
+	return std::min(index, bucketCount - 1);
+}
+
+double QuantileSketch::bucketValue(int index)
+{
+	// Midpoint (in relative terms) of (minValue * gamma^(i-1), minValue * gamma^i]
+	return minValue * 2.0 * std::pow(gamma(), index) / (gamma() + 1.0);
+}
+
+void QuantileSketch::add(double value)
+{
+	++buckets[bucketFor(value)];
+	++count;
+	minSeen = std::min(minSeen, value);
+	maxSeen = std::max(maxSeen, value);
+}
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+	for (int i = 0; i < bucketCount; ++i)
+		buckets[i] += other.buckets[i];
+	count += other.count;
+	minSeen = std::min(minSeen, other.minSeen);
+	maxSeen = std::max(maxSeen, other.maxSeen);
+}
+
+double QuantileSketch::quantile(double q) const
+{
+	if (count == 0) return 0.0;
+
+	q = std::min(std::max(q, 0.0), 1.0);
+	uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count - 1));
+
+	uint64_t seen = 0;
+	for (int i = 0; i < bucketCount; ++i)
+	{
+		seen += buckets[i];
+		if (seen > rank)
+			return std::min(std::max(bucketValue(i), minSeen), maxSeen);
+	}
+	return maxSeen;
+}
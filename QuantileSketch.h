@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// Fixed-memory quantile estimate over positive values (log-spaced buckets,
+// ~2% relative error). Two sketches merge exactly by adding bucket counts.
+class QuantileSketch
+{
+private:
+	static constexpr int bucketCount = 512;
+	static constexpr double minValue = 0.01;        // anything smaller lands in bucket 0
+	static constexpr double relativeAccuracy = 0.02;
+
+	std::array<uint64_t, bucketCount> buckets;
+	uint64_t count;
+	double minSeen;
+	double maxSeen;
+
+	static double gamma();
+	static int bucketFor(double value);
+	static double bucketValue(int index);
+
+public:
+	// Constructor
+	QuantileSketch();
+
+	// Recording
+	void add(double value);
+	void merge(const QuantileSketch& other);
+
+	// Queries
+	uint64_t size() const { return count; }
+	double min() const { return minSeen; }
+	double quantile(double q) const; // q in [0, 1]; 0 when empty
+};
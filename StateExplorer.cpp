@@ -0,0 +1,197 @@
+#include "StateExplorer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+StateExplorer::StateExplorer(unsigned threadCount) : threads(threadCount)
+{
+	if (threads == 0) threads = std::thread::hardware_concurrency();
+	if (threads == 0) threads = 1;
+}
+
+void StateExplorer::addInvariant(const std::string& name, std::function<bool(const ElectricalSystem&)> holds)
+{
+	invariants.push_back({ name, std::move(holds) });
+}
+
+void StateExplorer::addDefaultInvariants()
+{
+	addInvariant("STANDBY powered while battery online with charge", [](const ElectricalSystem& e) {
+		return !(e.getBatteryOnline() && e.getBatteryCharge() > 0.0) || e.getStandby().isPowered();
+	});
+
+	addInvariant("AC2 never fed by EXT while an IDG is online", [](const ElectricalSystem& e) {
+		bool anyIDG = e.getEng1GenOnline() || e.getEng2GenOnline();
+		return !(anyIDG && e.getAC2().isPowered() && e.getAC2().getPoweredBy() == e.getExtPwr().name());
+	});
+}
+
+uint32_t StateExplorer::encode(const ElectricalSystem& elec)
+{
+	static_assert(keyBits <= 32, "state key must fit in uint32_t");
+
+	uint32_t key = 0;
+	int bit = 0;
+
+	// A value wider than its field would alias another state and silently prune it
+	auto put = [&](uint32_t value, int width) {
+		assert(value < (1u << width));
+		key |= value << bit;
+		bit += width;
+	};
+
+	put(elec.getExtPwr().isOnline(), 1);
+
+	// Elapsed time only matters while spooling; beginStartup() resets it
+	for (const PowerSource* gen : { &elec.getAPUGen(), &elec.getEng1Gen(), &elec.getEng2Gen() })
+	{
+		double elapsed = gen->isStarting() ? gen->getStartupElapsed() : 0.0;
+		assert(elapsed == std::floor(elapsed)); // whole seconds with 1 s ticks
+
+		put(gen->isOnline(), 1);
+		put(gen->isStarting(), 1);
+		put(static_cast<uint32_t>(elapsed), 3);
+	}
+
+	// Exact only while charge moves in whole percent per tick
+	double charge = elec.getBatteryCharge();
+	assert(charge == std::floor(charge));
+
+	put(elec.getBatteryOnline(), 1);
+	put(static_cast<uint32_t>(charge), 7);
+
+	put(elec.getBTB1Closed(), 1);
+	put(elec.getBTB2Closed(), 1);
+
+	assert(bit == keyBits);
+	return key;
+}
+
+bool StateExplorer::markVisited(uint32_t key)
+{
+	uint64_t mask = uint64_t(1) << (key & 63);
+	return (visited[key >> 6].fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+}
+
+std::vector<PanelAction> StateExplorer::traceTo(uint32_t node) const
+{
+	std::vector<PanelAction> trace;
+	for (; node != 0; node = nodes[node].parent)
+		trace.push_back(nodes[node].action);
+	std::reverse(trace.begin(), trace.end());
+	return trace;
+}
+
+StateExplorer::Report StateExplorer::run()
+{
+	Report report;
+	std::vector<bool> reported(invariants.size(), false);
+
+	visited.reset(new std::atomic<uint64_t>[size_t(1) << (keyBits - 6)]());
+	nodes.clear();
+
+	// --- Power-up state (as main() leaves it before the first tick) ---
+	ElectricalSystem root;
+	root.recalculate();
+	markVisited(encode(root));
+	nodes.push_back({ 0, PanelAction::Wait });
+
+	for (size_t k = 0; k < invariants.size(); ++k)
+	{
+		if (!invariants[k].holds(root)) {
+			report.violations.push_back({ invariants[k].name, {} });
+			reported[k] = true;
+		}
+	}
+
+	std::vector<Entry> frontier;
+	frontier.push_back({ 0, root });
+
+	// Per-worker output for one level; merged in worker order after join
+	struct Found
+	{
+		uint32_t parent;
+		PanelAction action;
+		ElectricalSystem elec;
+	};
+	struct Batch
+	{
+		std::vector<Found> found;
+		std::vector<std::pair<size_t, size_t>> broken; // (found index, invariant index)
+	};
+
+	while (!frontier.empty())
+	{
+		size_t workers = std::min<size_t>(threads, frontier.size() / 64 + 1);
+		size_t chunk = (frontier.size() + workers - 1) / workers;
+		std::vector<Batch> batches(workers);
+
+		auto expand = [&](size_t w) {
+			size_t end = std::min(frontier.size(), (w + 1) * chunk);
+			for (size_t i = w * chunk; i < end; ++i)
+			{
+				for (int a = 0; a < panelActionCount; ++a)
+				{
+					ElectricalSystem next = frontier[i].elec;
+					applyPanelAction(next, static_cast<PanelAction>(a));
+					tickPanel(next, 1.0);
+
+					if (!markVisited(encode(next))) continue;
+
+					for (size_t k = 0; k < invariants.size(); ++k)
+						if (!invariants[k].holds(next))
+							batches[w].broken.push_back({ batches[w].found.size(), k });
+
+					batches[w].found.push_back({ frontier[i].node, static_cast<PanelAction>(a), std::move(next) });
+				}
+			}
+		};
+
+		std::vector<std::thread> pool;
+		for (size_t w = 1; w < workers; ++w) pool.emplace_back(expand, w);
+		expand(0);
+		for (auto& t : pool) t.join();
+
+		std::vector<Entry> nextFrontier;
+		for (auto& batch : batches)
+		{
+			uint32_t base = static_cast<uint32_t>(nodes.size());
+			for (auto& f : batch.found)
+			{
+				nextFrontier.push_back({ static_cast<uint32_t>(nodes.size()), std::move(f.elec) });
+				nodes.push_back({ f.parent, f.action });
+			}
+
+			for (const auto& b : batch.broken)
+			{
+				if (reported[b.second]) continue;
+				reported[b.second] = true;
+				report.violations.push_back({ invariants[b.second].name, traceTo(base + static_cast<uint32_t>(b.first)) });
+			}
+		}
+
+		if (!nextFrontier.empty()) ++report.depth;
+		frontier = std::move(nextFrontier);
+	}
+
+	report.statesVisited = nodes.size();
+	return report;
+}
+
+void StateExplorer::printReport(const Report& report) const
+{
+	std::cout << "States visited : " << report.statesVisited << "\n";
+	std::cout << "Max depth      : " << report.depth << " s\n";
+	std::cout << "Invariants     : " << invariants.size() << " checked, "
+		<< report.violations.size() << " violated\n";
+
+	for (const auto& v : report.violations)
+	{
+		std::cout << "\nVIOLATED: " << v.invariant << "\n";
+		if (v.trace.empty()) std::cout << "  (at power-up)\n";
+		for (size_t i = 0; i < v.trace.size(); ++i)
+			std::cout << "  " << (i + 1) << ". " << panelActionName(v.trace[i]) << "\n";
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ElectricalSystem.h"
+#include "PanelAction.h"
+
+// Breadth-first walk over every panel state reachable from power-up,
+// one ConsoleUI action + one second tick per edge.
+class StateExplorer
+{
+public:
+	struct Invariant
+	{
+		std::string name;
+		std::function<bool(const ElectricalSystem&)> holds;
+	};
+
+	struct Counterexample
+	{
+		std::string invariant;
+		std::vector<PanelAction> trace; // actions from power-up to the bad state
+	};
+
+	struct Report
+	{
+		uint64_t statesVisited = 0;
+		unsigned depth = 0;
+		std::vector<Counterexample> violations; // shortest trace per broken invariant
+	};
+
+	// Key layout (LSB first): EXT online, 3x gen {online, starting, elapsed s},
+	// battery online, battery charge %, BTB1, BTB2
+	static constexpr int keyBits = 26;
+
+private:
+	struct Node
+	{
+		uint32_t parent;
+		PanelAction action;
+	};
+
+	struct Entry
+	{
+		uint32_t node;
+		ElectricalSystem elec;
+	};
+
+	unsigned threads;
+	std::vector<Invariant> invariants;
+
+	std::unique_ptr<std::atomic<uint64_t>[]> visited; // one bit per state key
+	std::vector<Node> nodes;                           // parent links for traces
+
+	bool markVisited(uint32_t key);
+	std::vector<PanelAction> traceTo(uint32_t node) const;
+
+public:
+	// Constructor (0 = one worker per hardware thread)
+	StateExplorer(unsigned threadCount = 0);
+
+	// Invariants
+	void addInvariant(const std::string& name, std::function<bool(const ElectricalSystem&)> holds);
+	void addDefaultInvariants();
+
+	// Exploration
+	Report run();
+	void printReport(const Report& report) const;
+
+	static uint32_t encode(const ElectricalSystem& elec);
+};
@@ -1,8 +1,179 @@
+#include "BusStatistics.h"
+#include "CommandFuzzer.h"
 #include "ElectricalSystem.h"
 #include "ConsoleUI.h"
+#include "PanelAction.h"
+#include "StateExplorer.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
 
-int main() 
+// Optional numeric argument at argv[index]; the default stays when absent.
+// Rejects signs, junk and anything outside [minValue, maxValue].
+static bool parseCount(int argc, char* argv[], int index, uint64_t minValue, uint64_t maxValue, uint64_t& value)
 {
+    if (index >= argc) return true;
+
+    const char* text = argv[index];
+    if (*text < '0' || *text > '9') return false;
+
+    errno = 0;
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (errno == ERANGE || *end != '\0' || parsed < minValue || parsed > maxValue) return false;
+
+    value = parsed;
+    return true;
+}
+
+static int printUsage()
+{
+    std::cerr <<
+        "Usage: B38M_ElectricalPowerDistributionSystem [mode]\n"
+        "  (no mode)                      interactive panel\n"
+        "  --explore                      reachability check of all panel states\n"
+        "  --fleet [aircraft] [seconds]   Monte-Carlo bus statistics (defaults 1000, 3600)\n"
+        "  --fuzz [steps] [seed] [max sequence]\n"
+        "                                 control-API fuzzing (defaults 10000000, 1, 4096; max sequence 16-16777216)\n";
+    return 2;
+}
+
+// Monte-Carlo fleet: random menu presses, one statistics partial per worker thread
+static BusStatistics runFleet(unsigned aircraft, unsigned seconds)
+{
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<BusStatistics> partials(workers);
+    std::vector<std::thread> pool;
+
+    for (unsigned w = 0; w < workers; ++w)
+    {
+        pool.emplace_back([&, w] {
+            for (unsigned a = w; a < aircraft; a += workers)
+            {
+                std::mt19937 rng(a);
+                std::uniform_int_distribution<int> roll(0, panelActionCount * 10 - 1); // ~1 press per 10 s
+
+                ElectricalSystem elec;
+                elec.recalculate();
+                for (unsigned s = 0; s < seconds; ++s)
+                {
+                    int r = roll(rng);
+                    if (r < panelActionCount) applyPanelAction(elec, static_cast<PanelAction>(r));
+                    tickPanel(elec, 1.0);
+                    partials[w].observe(elec, 1.0);
+                }
+                partials[w].endAircraft();
+            }
+        });
+    }
+    for (auto& t : pool) t.join();
+
+    BusStatistics total;
+    for (const auto& p : partials) total.merge(p);
+    return total;
+}
+
+// Command-sequence fuzzing on every core; stops at the first failure
+static int runFuzz(uint64_t steps, uint64_t seed, size_t maxSequence)
+{
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<CommandFuzzer::Failure> failures(workers);
+    std::vector<uint64_t> stepsRun(workers, 0);
+    std::vector<uint64_t> standbyLosses(workers, 0);
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> pool;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned w = 0; w < workers; ++w)
+    {
+        pool.emplace_back([&, w] {
+            CommandFuzzer fuzzer(seed + w, maxSequence);
+            fuzzer.addDefaultEngines();
+
+            uint64_t share = steps / workers + (w < steps % workers ? 1 : 0);
+            const uint64_t batch = 1 << 20;
+            for (uint64_t done = 0; done < share && !failed; done += batch)
+            {
+                if (!fuzzer.run(std::min(batch, share - done), failures[w])) {
+                    failed = true;
+                    break;
+                }
+            }
+            stepsRun[w] = fuzzer.getStepsRun();
+            standbyLosses[w] = fuzzer.getStandbyLosses();
+        });
+    }
+    for (auto& t : pool) t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t total = 0, losses = 0;
+    for (uint64_t n : stepsRun) total += n;
+    for (uint64_t n : standbyLosses) losses += n;
+    std::cout << "Steps run : " << total << " on " << workers << " thread(s), "
+        << static_cast<uint64_t>(total / std::max(seconds, 1e-9)) << " steps/s\n";
+    std::cout << "Coverage  : STANDBY lost on empty battery " << losses << " times\n";
+
+    for (unsigned w = 0; w < workers; ++w)
+    {
+        if (failures[w].trace.empty()) continue;
+
+        std::cout << "\nFAILED: " << failures[w].check << " (seed " << seed + w
+            << ", sequence " << failures[w].sequence << ")\n";
+        for (size_t i = 0; i < failures[w].trace.size(); ++i)
+            std::cout << "  " << (i + 1) << ". " << CommandFuzzer::stepName(failures[w].trace[i]) << "\n";
+    }
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string mode = argc > 1 ? argv[1] : "";
+
+    // Offline reachability check of the whole panel state space
+    if (mode == "--explore")
+    {
+        if (argc > 2) return printUsage();
+
+        StateExplorer explorer;
+        explorer.addDefaultInvariants();
+
+        StateExplorer::Report report = explorer.run();
+        explorer.printReport(report);
+        return report.violations.empty() ? 0 : 1;
+    }
+
+    // Aggregate bus availability over many randomly operated aircraft
+    if (mode == "--fleet")
+    {
+        uint64_t aircraft = 1000, seconds = 3600;
+        if (argc > 4 || !parseCount(argc, argv, 2, 1, UINT_MAX, aircraft) || !parseCount(argc, argv, 3, 1, UINT_MAX, seconds))
+            return printUsage();
+
+        runFleet(static_cast<unsigned>(aircraft), static_cast<unsigned>(seconds)).printSummary();
+        return 0;
+    }
+
+    // Randomised control-API sequences with invariant and engine cross-checks
+    if (mode == "--fuzz")
+    {
+        uint64_t steps = 10000000, seed = 1, maxSequence = 4096;
+        if (argc > 5 || !parseCount(argc, argv, 2, 1, UINT64_MAX, steps) || !parseCount(argc, argv, 3, 0, UINT64_MAX, seed) ||
+            !parseCount(argc, argv, 4, 16, uint64_t(1) << 24, maxSequence))
+            return printUsage();
+
+        return runFuzz(steps, seed, static_cast<size_t>(maxSequence));
+    }
+
+    if (!mode.empty()) return printUsage();
+
     ElectricalSystem elec;
     ConsoleUI ui(elec);
 